@@ -54,6 +54,19 @@ String authorizedUID = "B9:0A:81:98";
 // Tempo que a cancela fica aberta (em milissegundos)
 #define TEMPO_ABERTA_MS 5000 
 
+// Cache de cartões recentes (debounce do leitor RFID)
+// Número de UIDs guardados e tempo (em milissegundos) desde a última leitura
+// durante o qual o mesmo cartão é respondido pela cache.
+// O leitor não lê com a cancela aberta, por isso a primeira leitura de um
+// cartão autorizado fica válida durante TEMPO_ABERTA_MS + CACHE_CARTOES_TTL_MS.
+// Cada nova leitura renova o prazo, logo um cartão mantido no leitor conta
+// como uma única apresentação.
+#define CACHE_CARTOES_TAM 4
+#define CACHE_CARTOES_TTL_MS 3000
+// Intervalo mínimo entre dois feedbacks de acesso negado (buzzer/LED),
+// independentemente do UID apresentado.
+#define INTERVALO_NEGADO_MS 2000
+
 // --- OBJETOS GLOBAIS ---
 MFRC522 mfrc522(SS_PIN, RST_PIN);
 // Servo removido
@@ -65,12 +78,85 @@ volatile EstadoCancela estadoCancela = FECHADA;
 volatile bool botaoPressionadoFlag = false; // Flag para a ISR
 unsigned long tempoAbertura = 0;
 
+// --- CACHE DE CARTÕES RECENTES ---
+// Só é acedida pela tarefa do leitor RFID, por isso não precisa de mutex.
+struct EntradaCacheCartao {
+  byte uid[10];               // UID em bruto (tamanho máximo suportado pelo MFRC522)
+  byte tamanho;               // 0 = entrada livre
+  bool autorizado;            // Última decisão tomada para este cartão
+  unsigned long validoAte;    // Instante (millis) em que a entrada expira
+};
+EntradaCacheCartao cacheCartoes[CACHE_CARTOES_TAM];
+
+// UID autorizado em bruto, convertido a partir de authorizedUID no setup()
+byte authorizedUIDBytes[10];
+byte authorizedUIDTamanho = 0;
+
+// Instante do último feedback de acesso negado (0 = ainda não houve)
+unsigned long ultimoFeedbackNegado = 0;
+
+// Contadores expostos na página web (escritos apenas pela tarefa RFID)
+// cacheHits: leituras respondidas pela cache (autorizadas ou negadas).
+// leiturasSuprimidas: leituras negadas sem feedback, por estarem em cache ou
+// por limite de INTERVALO_NEGADO_MS.
+volatile uint32_t cacheHits = 0;
+volatile uint32_t leiturasSuprimidas = 0;
+
 // --- FUNÇÃO DA INTERRUPÇÃO (ISR) ---
 // Deve ser o mais rápida possível. Apenas define uma flag.
 void IRAM_ATTR onBotaoPressionado() {
   botaoPressionadoFlag = true;
 }
 
+// --- FUNÇÕES AUXILIARES DO LEITOR RFID ---
+// Converte um UID no formato "AA:BB:CC:DD" para bytes em bruto.
+// Devolve o número de bytes convertidos.
+byte converterUID(const String &texto, byte *destino, byte maxBytes) {
+  byte n = 0;
+  int inicio = 0;
+  while (inicio < (int)texto.length() && n < maxBytes) {
+    int fim = texto.indexOf(':', inicio);
+    if (fim < 0) fim = texto.length();
+    destino[n++] = (byte) strtoul(texto.substring(inicio, fim).c_str(), NULL, 16);
+    inicio = fim + 1;
+  }
+  return n;
+}
+
+// Procura o UID na cache. Devolve a entrada se ainda não tiver expirado.
+EntradaCacheCartao* procurarCacheCartao(const byte *uid, byte tamanho, unsigned long agora) {
+  for (byte i = 0; i < CACHE_CARTOES_TAM; i++) {
+    EntradaCacheCartao &e = cacheCartoes[i];
+    if (e.tamanho == tamanho && memcmp(e.uid, uid, tamanho) == 0
+        && (long)(e.validoAte - agora) > 0) {
+      return &e;
+    }
+  }
+  return NULL;
+}
+
+// Guarda a decisão na cache. Reutiliza a entrada do mesmo UID (mesmo que
+// expirada), senão uma entrada livre, senão a que expira primeiro.
+void guardarCacheCartao(const byte *uid, byte tamanho, bool autorizado, unsigned long agora) {
+  int alvo = -1;
+  for (byte i = 0; i < CACHE_CARTOES_TAM && alvo < 0; i++) {
+    if (cacheCartoes[i].tamanho == tamanho && memcmp(cacheCartoes[i].uid, uid, tamanho) == 0) alvo = i;
+  }
+  for (byte i = 0; i < CACHE_CARTOES_TAM && alvo < 0; i++) {
+    if (cacheCartoes[i].tamanho == 0) alvo = i;
+  }
+  if (alvo < 0) {
+    alvo = 0;
+    for (byte i = 1; i < CACHE_CARTOES_TAM; i++) {
+      if ((long)(cacheCartoes[i].validoAte - cacheCartoes[alvo].validoAte) < 0) alvo = i;
+    }
+  }
+  memcpy(cacheCartoes[alvo].uid, uid, tamanho);
+  cacheCartoes[alvo].tamanho = tamanho;
+  cacheCartoes[alvo].autorizado = autorizado;
+  cacheCartoes[alvo].validoAte = agora + CACHE_CARTOES_TTL_MS + (autorizado ? TEMPO_ABERTA_MS : 0);
+}
+
 // =================================================================
 // TAREFA 1: CONTROLO DA CANCELA, LEDS E ESTADO (MÁQUINA DE ESTADOS)
 // =================================================================
@@ -135,6 +221,27 @@ void taskLeitorRFID(void * parameter) {
     // Só tenta ler se a cancela estiver fechada
     if (estadoCancela == FECHADA) {
       if (mfrc522.PICC_IsNewCardPresent() && mfrc522.PICC_ReadCardSerial()) {
+        unsigned long agora = millis();
+        byte tamanho = mfrc522.uid.size;
+
+        // Caminho rápido: cartão visto recentemente, a leitura é descartada
+        // sem reautorizar, sem imprimir nada, sem reabrir a cancela e sem
+        // repetir o feedback.
+        EntradaCacheCartao *entrada = procurarCacheCartao(mfrc522.uid.uidByte, tamanho, agora);
+        if (entrada != NULL) {
+          entrada->validoAte = agora + CACHE_CARTOES_TTL_MS; // Cartão mantido no leitor continua em cache
+          cacheHits++;
+          if (!entrada->autorizado) leiturasSuprimidas++;
+          mfrc522.PICC_HaltA();
+          mfrc522.PCD_StopCrypto1();
+          vTaskDelay(100 / portTICK_PERIOD_MS);
+          continue;
+        }
+
+        bool autorizado = tamanho == authorizedUIDTamanho
+                          && memcmp(mfrc522.uid.uidByte, authorizedUIDBytes, tamanho) == 0;
+        guardarCacheCartao(mfrc522.uid.uidByte, tamanho, autorizado, agora);
+
         String uid = "";
         for (byte i = 0; i < mfrc522.uid.size; i++) {
           uid += (mfrc522.uid.uidByte[i] < 0x10 ? "0" : "");
@@ -146,20 +253,27 @@ void taskLeitorRFID(void * parameter) {
         Serial.print("Cartao detectado. UID: ");
         Serial.println(uid);
 
-        if (uid.equals(authorizedUID)) {
+        if (autorizado) {
           Serial.println("Acesso AUTORIZADO.");
           estadoCancela = ABRINDO; // Dispara a máquina de estados
         } else {
           Serial.println("Acesso NEGADO.");
-          // Feedback de erro
-          tone(BUZZER_PIN, 500, 500);
-          digitalWrite(LED_VERMELHO_PIN, LOW);
-          delay(200);
-          digitalWrite(LED_VERMELHO_PIN, HIGH);
-          delay(200);
-          digitalWrite(LED_VERMELHO_PIN, LOW);
-          delay(200);
-          digitalWrite(LED_VERMELHO_PIN, HIGH);
+          // Limite global ao feedback de erro: vários cartões negados
+          // diferentes não podem repetir a sequência bloqueante de buzzer/LED.
+          if (ultimoFeedbackNegado != 0 && agora - ultimoFeedbackNegado < INTERVALO_NEGADO_MS) {
+            leiturasSuprimidas++;
+          } else {
+            ultimoFeedbackNegado = agora;
+            // Feedback de erro
+            tone(BUZZER_PIN, 500, 500);
+            digitalWrite(LED_VERMELHO_PIN, LOW);
+            delay(200);
+            digitalWrite(LED_VERMELHO_PIN, HIGH);
+            delay(200);
+            digitalWrite(LED_VERMELHO_PIN, LOW);
+            delay(200);
+            digitalWrite(LED_VERMELHO_PIN, HIGH);
+          }
         }
 
         mfrc522.PICC_HaltA();
@@ -184,6 +298,7 @@ const char index_html[] PROGMEM = R"rawliteral(
     <div class="container">
         <h1>Sistema D - Controlo de Acessos</h1>
         <p>Estado da Cancela: <span id="estado">A carregar...</span></p>
+        <p class="stats">Leituras respondidas pela cache: <span id="cacheHits">0</span> | Acessos negados sem feedback: <span id="suprimidas">0</span></p>
         <div class="card">
             <h2>Desbloqueio Remoto</h2>
             <form id="unlockForm">
@@ -201,6 +316,8 @@ const char index_html[] PROGMEM = R"rawliteral(
                 .then(response => response.json())
                 .then(data => {
                     document.getElementById('estado').textContent = data.estado;
+                    document.getElementById('cacheHits').textContent = data.cacheHits;
+                    document.getElementById('suprimidas').textContent = data.leiturasSuprimidas;
                 })
                 .catch(error => console.error('Erro ao buscar estado:', error));
         }
@@ -235,6 +352,7 @@ body { font-family: Arial, sans-serif; background-color: #f0f2f5; margin: 0; pad
 h1 { color: #333; }
 p { font-size: 1.2em; }
 #estado { font-weight: bold; color: #007bff; }
+.stats { font-size: 0.9em; color: #666; }
 .card { background: #f9f9f9; border: 1px solid #ddd; padding: 15px; margin-top: 20px; border-radius: 5px; }
 input[type="text"], input[type="password"] { width: calc(100% - 22px); padding: 10px; margin: 5px 0; border: 1px solid #ccc; border-radius: 4px; }
 button { width: 100%; padding: 10px; background-color: #007bff; color: white; border: none; border-radius: 4px; cursor: pointer; font-size: 1em; }
@@ -260,6 +378,7 @@ void setup() {
   
   SPI.begin();
   mfrc522.PCD_Init();
+  authorizedUIDTamanho = converterUID(authorizedUID, authorizedUIDBytes, sizeof(authorizedUIDBytes));
   
   Serial.println("\nHardware inicializado.");
 
@@ -289,7 +408,11 @@ void setup() {
       case ABERTA: json += "Aberta"; break;
       case FECHANDO: json += "Fechando..."; break;
     }
-    json += "\"}";
+    json += "\", \"cacheHits\": ";
+    json += cacheHits;
+    json += ", \"leiturasSuprimidas\": ";
+    json += leiturasSuprimidas;
+    json += "}";
     request->send(200, "application/json", json);
   });
 